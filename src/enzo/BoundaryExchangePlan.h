@@ -0,0 +1,147 @@
+/***********************************************************************
+/
+/  BOUNDARY EXCHANGE PLAN CLASS
+/
+/  date:       October, 2026
+/
+/  PURPOSE:
+/    A cached description of a sibling exchange on one level: either
+/    the ghost-zone copy of the baryon fields (the CopyZonesFromGrid
+/    part of SetBoundaryConditions) or the copy of the gravitating
+/    mass field (the CopyOverlappingMassField part of
+/    PrepareDensityField).
+/
+/    The plan is recorded by running the usual CheckForOverlap loop
+/    with grid::AddToBoundaryExchangePlan (or
+/    grid::AddMassFieldToBoundaryExchangePlan) in place of the copy
+/    function.  Every overlap that involves this processor becomes a
+/    region (destination grid, source grid, start indices in both and
+/    the region size), and the regions are grouped by the remote
+/    processor and sorted into an order that both sides agree on.
+/
+/    Replaying the plan sends exactly one packed message to, and
+/    receives one packed message from, each neighbouring processor.
+/    The messages use persistent requests (MPI_Send_init/Recv_init)
+/    on buffers owned by the plan, so after the first replay no
+/    geometry is recomputed and no buffers or requests are created.
+/
+/    A plan stays valid until the hierarchy is rebuilt (see
+/    RebuildHierarchy) or the grids on the level change.
+/
+************************************************************************/
+
+#ifndef BOUNDARY_EXCHANGE_PLAN_DEFINED__
+#define BOUNDARY_EXCHANGE_PLAN_DEFINED__
+
+#ifdef USE_MPI
+#include "mpi.h"
+#endif /* USE_MPI */
+#include <map>
+#include <vector>
+
+/* What a plan exchanges. */
+
+#define BOUNDARY_EXCHANGE_BARYON_FIELDS   0
+#define BOUNDARY_EXCHANGE_MASS_FIELD      1
+#define NUMBER_OF_BOUNDARY_EXCHANGE_KINDS 2
+
+struct BoundaryExchangeRegion {
+  grid *ToGrid;                  // grid receiving the ghost zones
+  grid *FromGrid;                // grid supplying the (active) zones
+  int ToIndex;                   // position of ToGrid in Grids[]
+  int FromIndex;                 // position of FromGrid in Grids[]
+  int Order;                     // periodic image number for this pair
+  int Processor;                 // processor of the other grid
+  int Start[MAX_DIMENSION];      // start in ToGrid
+  int StartOther[MAX_DIMENSION]; // start in FromGrid
+  int Dim[MAX_DIMENSION];        // size of the region
+  long Offset;                   // cell offset within the peer message
+};
+
+struct BoundaryExchangePeer {
+  int Processor;
+  int FirstRegion;
+  int NumberOfRegions;
+  long NumberOfCells;            // cells per field in the message
+};
+
+/* Buffers and persistent requests for one number of fields (the
+   acceleration boundary reuses the baryon plan with GridRank fields). */
+
+struct BoundaryExchangeRequests {
+  int NumberOfFields;
+  float *SendBuffer;
+  float *ReceiveBuffer;
+#ifdef USE_MPI
+  MPI_Request *SendRequest;
+  MPI_Request *ReceiveRequest;
+#endif /* USE_MPI */
+};
+
+class BoundaryExchangePlan
+{
+ private:
+  int Level;
+  int Kind;                      // BOUNDARY_EXCHANGE_*
+  int Generation;                // hierarchy generation when recorded
+
+  /* Grids[] at the time of recording, used to detect changes. */
+
+  std::vector<grid *> GridPointer;
+  std::vector<int> GridProcessor;
+  std::map<grid *, int> GridIndex;   // only filled while recording
+
+  std::vector<BoundaryExchangeRegion> LocalRegions;
+  std::vector<BoundaryExchangeRegion> SendRegions;
+  std::vector<BoundaryExchangeRegion> ReceiveRegions;
+  std::vector<BoundaryExchangePeer> SendPeers;
+  std::vector<BoundaryExchangePeer> ReceivePeers;
+
+  std::vector<BoundaryExchangeRequests> Requests;
+
+  void GroupByPeer(std::vector<BoundaryExchangeRegion> &Regions,
+		   std::vector<BoundaryExchangePeer> &Peers);
+  BoundaryExchangeRequests *RequestsFor(int NumberOfFields);
+  void FreeRequests(void);
+
+  int FieldCount(grid *Grid);
+  float *Field(grid *Grid, int field);
+  int *FieldDimension(grid *Grid);
+
+  static int HierarchyGeneration;
+  static BoundaryExchangePlan *CurrentPlan;
+
+ public:
+  BoundaryExchangePlan(int level, int kind);
+  ~BoundaryExchangePlan(void);
+
+  /* Returns the (possibly empty) plan for a level. */
+
+  static BoundaryExchangePlan *ForLevel(int level,
+				int kind = BOUNDARY_EXCHANGE_BARYON_FIELDS);
+
+  /* Marks every plan as stale; called when the hierarchy is rebuilt. */
+
+  static void InvalidateAll(void);
+
+  /* The plan that the grid recording methods add to. */
+
+  static BoundaryExchangePlan *RecordingPlan(void) { return CurrentPlan; };
+
+  int IsValid(HierarchyEntry *Grids[], int NumberOfGrids);
+  void BeginRecording(HierarchyEntry *Grids[], int NumberOfGrids);
+  void AddRegion(grid *ToGrid, grid *FromGrid, int Start[],
+		 int StartOther[], int Dim[]);
+  void EndRecording(void);
+
+  /* Carries out the exchange described by the plan. */
+
+  int Exchange(void);
+
+  int ReturnKind(void) { return Kind; };
+  int ReturnNumberOfMessages(void) { return SendPeers.size(); };
+  int ReturnNumberOfRegions(void)
+    { return LocalRegions.size() + SendRegions.size() + ReceiveRegions.size(); };
+};
+
+#endif
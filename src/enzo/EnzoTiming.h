@@ -12,7 +12,16 @@
 /       section_performance: Contains timing information for a single 
 /           code section
 /       enzo_timer: Contains general information and section_performance 
-/           objects.
+/           objects, plus named event counters.
+/
+/   Timers can be nested: while a scope timer (a level) runs, timers
+/   started with TIMER_START_CHILD are named "<scope>/<name>", e.g.
+/   Level_02/Hydro.  These only appear in the JSON lines output
+/   (performance.jsonl), which also carries the rates and, optionally,
+/   the time of every processor; performance.out is unchanged.
+/
+/   Every start and stop is also recorded in the event trace, when it
+/   is on (see EventTrace.h).
 /
 ************************************************************************/
 
@@ -23,11 +32,19 @@
 #include "mpi.h"
 #endif /* USE_MPI */
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <stdio.h>
 #include <math.h>
+#include <cmath>
 #include <string>
 #include <cstring>
 #include <map>
+#include <vector>
+
+#include "EventTrace.h"
 
 template <typename T>
 T min(const T& A, const T& B) {
@@ -41,6 +58,8 @@ T max(const T& A, const T& B) {
 
 double ReturnWallTime(void);
 void Reduce_Times(double time, double *time_array);
+void Reduce_Sums(double *values, double *sums, int n);
+void Reduce_Names(std::string &names);
 
 namespace enzo_timing{
 
@@ -61,6 +80,7 @@ namespace enzo_timing{
       total_time = 0.0;
       current_time = 0.0;
       ncell_updates = 0;
+      nbytes = 0;
     }
    
     // Start Timer 
@@ -89,6 +109,7 @@ namespace enzo_timing{
     void reset_current_time(void){
       current_time = 0.0;
       ncell_updates = 0.0;
+      nbytes = 0.0;
     }
 
     // Access the ncell_updates counter
@@ -111,11 +132,22 @@ namespace enzo_timing{
       ncell_updates += my_ncell_updates;
     }
 
+    // Add bytes moved (e.g. communicated) by this section
+    void add_bytes(double my_nbytes){
+      nbytes += my_nbytes;
+    }
+
+    // Access the bytes moved since write-out
+    double get_bytes(void){
+      return nbytes;
+    }
+
     std::string name;           // Name of the timer
     section_performance *next;  // Pointer to the next timer 
   
   private:
     double ncell_updates; // Number of cell updates since write-out
+    double nbytes;        // Bytes moved since write-out
     double t0;            // Start Time
     double t1;            // End Time
     double total_time;    // Total time during the simulation
@@ -124,6 +156,7 @@ namespace enzo_timing{
     
   };
   typedef std::map<std::string, section_performance *> SectionMap;
+  typedef std::map<std::string, double> CounterMap;
 
   /* --------------------------------------------------------- */
 
@@ -140,6 +173,8 @@ namespace enzo_timing{
       total_time = 0.0;
       current_time = 0.0;
       filename = (char *)("performance.out");
+      json_filename = (char *)("performance.jsonl");
+      json_output = 0;
       set_mpi_environment();
       first_write = true;
       //last_cycle = 0;
@@ -150,6 +185,8 @@ namespace enzo_timing{
       total_time = 0.0;
       current_time = 0.0;
       filename = performance_name;
+      json_filename = (char *)("performance.jsonl");
+      json_output = 0;
       set_mpi_environment();
       first_write = true;
       //last_cycle = 0;
@@ -192,17 +229,110 @@ namespace enzo_timing{
       return;
     }
 
-    // Start a timer by name
+    // Named counters (e.g. heap allocations avoided).  These are
+    // summed between write-outs and reset afterwards, like the
+    // current time of a timer.
+    CounterMap counters;
+
+    void add_count(char *name, double count){
+      counters[name] += count;
+    }
+
+    // Counters that keep the largest value passed in (e.g. bytes held).
+    void max_count(char *name, double value){
+      double &count = counters[name];
+      if (value > count) count = value;
+    }
+
+    // Start a timer by name.  Timers are not thread-safe, so any
+    // that are hit from inside the threaded grid loops are skipped;
+    // the time is still counted by the enclosing level timer.
     void start(char *name){
+#ifdef _OPENMP
+      if (omp_in_parallel()) return;
+#endif
       this->create(name);
       timers[name]->start();
+      TRACE_BEGIN(name);
     }
 
     // Stop a timer by name
     void stop(char *name){
+#ifdef _OPENMP
+      if (omp_in_parallel()) return;
+#endif
       timers[name]->stop();
+      TRACE_END(name);
+    }
+
+    // Scope timers: child timers started while one runs are named
+    // after it.  The scope stays set across plain stop/start pairs of
+    // the same timer and is cleared by stop_scope.
+    std::string scope;
+
+    void start_scope(char *name){
+#ifdef _OPENMP
+      if (omp_in_parallel()) return;
+#endif
+      this->start(name);
+      scope = name;
+    }
+
+    void stop_scope(char *name){
+#ifdef _OPENMP
+      if (omp_in_parallel()) return;
+#endif
+      this->stop(name);
+      scope.clear();
+    }
+
+    std::string child_name(const char *name){
+      return scope.empty() ? std::string(name) : scope + "/" + name;
+    }
+
+    void start_child(char *name){
+#ifdef _OPENMP
+      if (omp_in_parallel()) return;
+#endif
+      std::string full = child_name(name);
+      SectionMap::iterator iter = timers.find(full);
+      if (iter == timers.end())
+        iter = timers.insert(std::make_pair(full,
+                 new section_performance((char *) full.c_str()))).first;
+      iter->second->start();
+      TRACE_BEGIN(full.c_str());
+    }
+
+    void stop_child(char *name){
+#ifdef _OPENMP
+      if (omp_in_parallel()) return;
+#endif
+      SectionMap::iterator iter = timers.find(child_name(name));
+      if (iter != timers.end()){
+        iter->second->stop();
+        TRACE_END(iter->first.c_str());
+      }
     }
 
+    // Count bytes moved by a section, for the bytes/s rate.
+    void add_bytes(char *name, double bytes){
+#ifdef _OPENMP
+      if (omp_in_parallel()) return;
+#endif
+      this->create(name);
+      timers[name]->add_bytes(bytes);
+    }
+
+    // Level timers are the top-level Level_N ones, not their children.
+    bool is_level_timer(const std::string &name){
+      return (strncmp(name.c_str(), "Level", 5) == 0 &&
+              name.find('/') == std::string::npos);
+    }
+
+    // 0: performance.out only.  1: also performance.jsonl.  2: with
+    // the time of every processor in performance.jsonl.
+    int json_output;
+
     // Get a level section_performance by level
     section_performance * get_level(int level){
       char level_name[256];
@@ -225,7 +355,7 @@ namespace enzo_timing{
       std::string keyname;
       for( SectionMap::iterator iter=timers.begin(); iter!=timers.end(); ++iter){
         keyname = iter->first;
-        if (strncmp(keyname.c_str(), "Level", 5) == 0){
+        if (is_level_timer(keyname)){
           total_time += iter->second->get_total_time();
         }
       }
@@ -238,7 +368,7 @@ namespace enzo_timing{
       std::string keyname;
       for( SectionMap::iterator iter=timers.begin(); iter!=timers.end(); ++iter){
         keyname = iter->first;
-        if (strncmp(keyname.c_str(), "Level", 5) == 0){
+        if (is_level_timer(keyname)){
           total_grids += iter->second->get_grids();
         }
       }
@@ -251,7 +381,7 @@ namespace enzo_timing{
       std::string keyname;
       for( SectionMap::iterator iter=timers.begin(); iter!=timers.end(); ++iter){
         keyname = iter->first;
-        if (strncmp(keyname.c_str(), "Level", 5) == 0){
+        if (is_level_timer(keyname)){
           total_cells += iter->second->get_cells();
         }
       }
@@ -273,7 +403,7 @@ namespace enzo_timing{
       std::string keyname;
       for( SectionMap::iterator iter=timers.begin(); iter!=timers.end(); ++iter){
         keyname = iter->first;
-        if (strncmp(keyname.c_str(), "Level", 5) == 0){
+        if (is_level_timer(keyname)){
           total_time += iter->second->get_current_time();
         }
       }
@@ -299,9 +429,31 @@ namespace enzo_timing{
       return;
     } 
 
+    // Make every processor hold the same timers and counters, so that
+    // they are reduced in the same order.  Timers that were only hit
+    // on some processors are created (empty) on the others.
+    void synchronize_names(void){
+      std::string names;
+      for( SectionMap::iterator iter=timers.begin(); iter!=timers.end(); ++iter)
+        names += "T" + iter->first + "\n";
+      for( CounterMap::iterator iter=counters.begin(); iter!=counters.end(); ++iter)
+        names += "C" + iter->first + "\n";
+      Reduce_Names(names);
+      size_t start = 0, end;
+      while ((end = names.find('\n', start)) != std::string::npos){
+        std::string name = names.substr(start+1, end-start-1);
+        if (names[start] == 'T')
+          this->create((char *) name.c_str());
+        else
+          counters[name];
+        start = end+1;
+      }
+    }
+
     // Write out performance measures to a file, optionally specifying
     // verbose to get all timers from all processors.
     void write_out(int step, bool verbose=false){
+      this->synchronize_names();
       if (my_rank == 0){
         performance_file = fopen(filename,"a");
         if (step == 1){
@@ -329,54 +481,175 @@ namespace enzo_timing{
       if (my_rank == 0){
         fprintf(performance_file, "Cycle_Number %d\n",step);
       }
+
+      // Bytes moved by each timer, summed over processors.
+      int ntimers = timers.size(), n = 0;
+      std::vector<double> bytes(ntimers+1), total_bytes(ntimers+1);
+      for( SectionMap::iterator iter=timers.begin(); iter!=timers.end(); ++iter)
+        bytes[n++] = iter->second->get_bytes();
+      Reduce_Sums(&bytes[0], &total_bytes[0], ntimers);
+
+      json_table table;
       
       double total_cells = get_total_cells();
+      // Cells and grids of the levels, kept for their children since
+      // the levels are reset as they are written.
+      std::map<std::string, std::pair<double, long int> > level_work;
+      for( SectionMap::iterator iter=timers.begin(); iter!=timers.end(); ++iter)
+        if (is_level_timer(iter->first))
+          level_work[iter->first] = std::make_pair(iter->second->get_cells(),
+                                                   iter->second->get_grids());
       double cell_rate; 
       // Print out info for each timer.
-      for( SectionMap::iterator iter=timers.begin(); iter!=timers.end(); ++iter){
+      n = 0;
+      for( SectionMap::iterator iter=timers.begin(); iter!=timers.end(); ++iter, ++n){
         current_time = iter->second->get_current_time();
         Reduce_Times(current_time, time_array);
         cell_rate = 0.0;
         if (my_rank == 0){
           this->analyze_times(time_array, nprocs, &mean_time, &stddev_time, &min_time, &max_time);
-
-          fprintf(performance_file, "%s %e %e %e %e",
-                  iter->first.c_str(), mean_time, stddev_time, min_time, max_time);
           keyname = iter->first;
+          double cells = 0.0;
+          long int grids = 0;
           if (strncmp(keyname.c_str(), "Total", 5) == 0){
             total_time = mean_time;
-            if (total_time > 0.0)
-              cell_rate = (double)(total_cells/total_time/nprocs);
-            // Write out total cells divided by processor-seconds.
-            fprintf(performance_file, " %e %ld %e",
-                    total_cells,
-                    get_total_grids(),
-                    cell_rate); 
+            cells = total_cells;
+            grids = get_total_grids();
           }
-          if (strncmp(keyname.c_str(), "Level", 5) == 0){
-            if (mean_time > 0.0)
-              cell_rate = (double)(iter->second->get_cells()/mean_time/nprocs);
-            // Write out level cells divided by processor-seconds.
-            fprintf(performance_file, " %e %ld %e", 
-                    iter->second->get_cells(),
-                    iter->second->get_grids(),
-                    cell_rate);
+          else if (strncmp(keyname.c_str(), "Level", 5) == 0){
+            // Children of a level are rated by the cells of the level.
+            std::map<std::string, std::pair<double, long int> >::iterator level =
+              level_work.find(keyname.substr(0, keyname.find('/')));
+            if (level != level_work.end()){
+              cells = level->second.first;
+              grids = level->second.second;
+            }
           }
-          if(verbose){
-            for (int i=0; i<nprocs; i++){
-              fprintf(performance_file, " %e", time_array[i]);
+          if (mean_time > 0.0)
+            cell_rate = (double)(cells/mean_time/nprocs);
+
+          if (keyname.find('/') == std::string::npos){
+            fprintf(performance_file, "%s %e %e %e %e",
+                    iter->first.c_str(), mean_time, stddev_time, min_time, max_time);
+            // Write out total or level cells divided by processor-seconds.
+            if (strncmp(keyname.c_str(), "Total", 5) == 0 ||
+                strncmp(keyname.c_str(), "Level", 5) == 0)
+              fprintf(performance_file, " %e %ld %e",
+                      cells, grids, cell_rate);
+            if(verbose){
+              for (int i=0; i<nprocs; i++){
+                fprintf(performance_file, " %e", time_array[i]);
+              }
             }
+            fprintf(performance_file, "\n");
           }
-          fprintf(performance_file, "\n");
+
+          if (json_output)
+            table.add(keyname, mean_time, stddev_time, min_time, max_time,
+                      cells, grids, cell_rate,
+                      (mean_time > 0.0) ? total_bytes[n]/nprocs/mean_time : 0.0,
+                      (json_output > 1) ? time_array : NULL, nprocs);
         }
         iter->second->reset_current_time();
       }
 
+      // Counters are written as comments so that they do not show up
+      // as timers in performance_tools.
+      json_table counter_table;
+      for( CounterMap::iterator iter=counters.begin(); iter!=counters.end(); ++iter){
+        Reduce_Times(iter->second, time_array);
+        if (my_rank == 0){
+          this->analyze_times(time_array, nprocs, &mean_time, &stddev_time, &min_time, &max_time);
+          fprintf(performance_file, "# Counter %s %e %e %e %e\n",
+                  iter->first.c_str(), mean_time, stddev_time, min_time, max_time);
+          if (json_output)
+            counter_table.add(iter->first, mean_time, stddev_time, min_time, max_time,
+                              0.0, 0, 0.0, 0.0, NULL, nprocs);
+        }
+        iter->second = 0.0;
+      }
+
       if (my_rank == 0){
         fprintf(performance_file, "\n");
         fclose(performance_file);      
         delete [] time_array;
+        if (json_output)
+          this->write_json(step, table, counter_table);
+      }
+    }
+
+    // Columns of one cycle of the JSON lines output.
+    struct json_table {
+      std::vector<std::string> name;
+      std::vector<double> mean, stddev, minimum, maximum, cells, cell_rate, byte_rate;
+      std::vector<long int> grids;
+      std::vector<std::vector<double> > ranks;
+      void add(const std::string &n, double mean_t, double stddev_t,
+               double min_t, double max_t, double c, long int g, double cr,
+               double br, double *per_rank, int nranks){
+        name.push_back(n);
+        mean.push_back(mean_t); stddev.push_back(stddev_t);
+        minimum.push_back(min_t); maximum.push_back(max_t);
+        cells.push_back(c); grids.push_back(g);
+        cell_rate.push_back(cr); byte_rate.push_back(br);
+        if (per_rank != NULL)
+          ranks.push_back(std::vector<double>(per_rank, per_rank+nranks));
+      }
+    };
+
+    void write_json_column(FILE *fptr, const char *key, std::vector<double> &column){
+      fprintf(fptr, ", \"%s\": [", key);
+      // JSON has no nan or inf.
+      for (size_t i = 0; i < column.size(); i++)
+        fprintf(fptr, (i == 0) ? "%.6e" : ", %.6e",
+                std::isfinite(column[i]) ? column[i] : 0.0);
+      fprintf(fptr, "]");
+    }
+
+    // Appends one line to performance.jsonl: a JSON object holding the
+    // timers and the counters as columns (one array per quantity),
+    // e.g. {"cycle": 5, "nprocs": 4, "wall_time": ..., "timers":
+    // {"name": [...], "mean": [...], ...}, "counters": {...}}.
+    void write_json(int step, json_table &table, json_table &counter_table){
+      FILE *fptr = fopen(json_filename, "a");
+      if (fptr == NULL) return;
+      fprintf(fptr, "{\"cycle\": %d, \"nprocs\": %d, \"wall_time\": %.6e",
+              step, nprocs, ReturnWallTime());
+      json_table *tables[2] = {&table, &counter_table};
+      const char *table_names[2] = {"timers", "counters"};
+      for (int t = 0; t < 2; t++){
+        json_table &tab = *tables[t];
+        fprintf(fptr, ", \"%s\": {\"name\": [", table_names[t]);
+        for (size_t i = 0; i < tab.name.size(); i++)
+          fprintf(fptr, (i == 0) ? "\"%s\"" : ", \"%s\"", tab.name[i].c_str());
+        fprintf(fptr, "]");
+        write_json_column(fptr, "mean", tab.mean);
+        write_json_column(fptr, "stddev", tab.stddev);
+        write_json_column(fptr, "min", tab.minimum);
+        write_json_column(fptr, "max", tab.maximum);
+        if (t == 0){
+          write_json_column(fptr, "cells", tab.cells);
+          fprintf(fptr, ", \"grids\": [");
+          for (size_t i = 0; i < tab.grids.size(); i++)
+            fprintf(fptr, (i == 0) ? "%ld" : ", %ld", tab.grids[i]);
+          fprintf(fptr, "]");
+          write_json_column(fptr, "cells_per_sec", tab.cell_rate);
+          write_json_column(fptr, "bytes_per_sec", tab.byte_rate);
+          if (!tab.ranks.empty()){
+            fprintf(fptr, ", \"ranks\": [");
+            for (size_t i = 0; i < tab.ranks.size(); i++){
+              fprintf(fptr, (i == 0) ? "[" : ", [");
+              for (size_t r = 0; r < tab.ranks[i].size(); r++)
+                fprintf(fptr, (r == 0) ? "%.6e" : ", %.6e", tab.ranks[i][r]);
+              fprintf(fptr, "]");
+            }
+            fprintf(fptr, "]");
+          }
+        }
+        fprintf(fptr, "}");
       }
+      fprintf(fptr, "}\n");
+      fclose(fptr);
     }
           
   private:
@@ -384,6 +657,7 @@ namespace enzo_timing{
     double total_time;      // Total time
     double current_time;    // Current Time since last write_out
     char * filename;        // Filename
+    char * json_filename;   // Filename of the JSON lines output
     int my_rank;            // MPI Rank
     int nprocs;             // MPI Size
     //int last_cycle;         // The last cycle number that was written out.
@@ -408,6 +682,14 @@ EXTERN enzo_timing::enzo_timer *enzo_timer;   // Add global timer
 #define TIMER_REGISTER(name) enzo_timer->create(name)
 #define TIMER_ADD_CELLS(level, cells) enzo_timer->get_level(level)->add_cells(cells)
 #define TIMER_SET_NGRIDS(level, grids) enzo_timer->get_level(level)->set_ngrids(grids)
+#define TIMER_ADD_COUNT(counter_name, count) enzo_timer->add_count(counter_name, count)
+#define TIMER_MAX_COUNT(counter_name, value) enzo_timer->max_count(counter_name, value)
+#define TIMER_START_SCOPE(section_name) enzo_timer->start_scope(section_name)
+#define TIMER_STOP_SCOPE(section_name) enzo_timer->stop_scope(section_name)
+#define TIMER_START_CHILD(name) enzo_timer->start_child(name)
+#define TIMER_STOP_CHILD(name) enzo_timer->stop_child(name)
+#define TIMER_ADD_BYTES(section_name, bytes) enzo_timer->add_bytes(section_name, bytes)
+#define TIMER_SET_JSON_OUTPUT(mode) enzo_timer->json_output = mode
 #else
 #define TIMER_START(section_name)
 #define TIMER_STOP(section_name)
@@ -415,6 +697,14 @@ EXTERN enzo_timing::enzo_timer *enzo_timer;   // Add global timer
 #define TIMER_REGISTER(name)
 #define TIMER_ADD_CELLS(level, cells)
 #define TIMER_SET_NGRIDS(level, grids)
+#define TIMER_ADD_COUNT(counter_name, count)
+#define TIMER_MAX_COUNT(counter_name, value)
+#define TIMER_START_SCOPE(section_name)
+#define TIMER_STOP_SCOPE(section_name)
+#define TIMER_START_CHILD(name)
+#define TIMER_STOP_CHILD(name)
+#define TIMER_ADD_BYTES(section_name, bytes)
+#define TIMER_SET_JSON_OUTPUT(mode)
 #endif
 
 #endif //ENZO_TIMING
@@ -0,0 +1,35 @@
+/***********************************************************************
+/
+/  EVENT TRACE
+/
+/  date:       October, 2026
+/
+/  PURPOSE:
+/    Timestamped begin/end events for an event timeline of a range of
+/    cycles (see EventTrace.C).  Every timer of EnzoTiming.h records
+/    its start and stop here, and other code can add spans with
+/
+/      TRACE_BEGIN("Name");
+/      ...
+/      TRACE_END("Name");
+/
+/    When tracing is off, each of these is a test of one flag.
+/
+************************************************************************/
+
+#ifndef EVENT_TRACE_DEFINED__
+#define EVENT_TRACE_DEFINED__
+
+#define MAX_EVENT_TRACE_THREADS  256
+#define EVENT_TRACE_NAME_LENGTH   40
+
+extern bool EventTraceActive;
+
+void EventTraceRecord(const char *name, char type);
+
+#define TRACE_BEGIN(name) \
+  ((EventTraceActive) ? EventTraceRecord(name, 'B') : (void) 0)
+#define TRACE_END(name) \
+  ((EventTraceActive) ? EventTraceRecord(name, 'E') : (void) 0)
+
+#endif
@@ -23,6 +23,11 @@
 
 #define  HUBBLE      3.2407789e-18   /* in h/sec */
 
+/* HaloFinderMethod */
+
+#define  HALO_FINDER_SLABS       0
+#define  HALO_FINDER_UNION_FIND  1
+
 #define  SEC_PER_MEGAYEAR   3.155e13
 #define  SEC_PER_YEAR       3.155e7
 
@@ -59,6 +64,12 @@ struct FOF_particle_data
   //int           GridID;
 };
 
+struct group_properties
+{
+  float   cm[3], cmv[3], AM[3];
+  float   mtot, mstars, mvir, rvir, vrms, spin;
+};
+
 struct id_data 
 {
   PINT    ID;
@@ -23,7 +23,7 @@ void   find_minids(FOFData &AllVars);
 void   find_subgroups(FOFData &D);
 int    get_particles(int dest, int minid, int len, FOF_particle_data *buf, 
 		     FOFData &AllVars);
-void   get_properties(FOFData D, FOF_particle_data *p, int len, bool subgroup, float *pcm, 
+void   get_properties(FOFData &D, FOF_particle_data *p, int len, bool subgroup, float *pcm, 
 		      float *pcmv, float *pmtot, float *pmstars, float *pmvir,
 		      float *prvir, float *pL, float *pvrms, float *pspin);
 void   iindexx(int n, int arr[], int indx[]);
@@ -0,0 +1,436 @@
+/***********************************************************************
+/
+/  FAST FOURIER TRANSFORM PLAN CLASS
+/
+/  date:       October, 2026
+/
+/  PURPOSE:
+/    A one-dimensional transform of a fixed length: the factorization
+/    of the length into radices 4, 2, 3, 5 (and any other prime) and
+/    the twiddle factors of every pass of a self-sorting (Stockham)
+/    mixed-radix FFT, worked out once and then applied to any number
+/    of lines.
+/
+/    Complex lines are interleaved (re, im) pairs.  A real line of
+/    length n is held in n+2 elements; the forward real-to-complex
+/    transform replaces it with the n/2+1 complex coefficients of the
+/    non-negative frequencies, using a complex transform of half the
+/    length for even n.
+/
+/    The convention is that of the other FFTs in Enzo: the forward
+/    transform (FFT_FORWARD) is exp(-i k x) and unnormalized, and the
+/    inverse is exp(+i k x) and divided by the length.
+/
+/    Plans are kept for the run; ForLength returns the cached plan.  A
+/    plan has its own scratch space, so it is not thread safe.
+/
+/    Real is the type of the data: float in Enzo, FLOAT in inits (which
+/    includes this file from ../enzo).  The definitions are below the
+/    class, so the file has to be included after macros_and_parameters.h
+/    and <map> and <math.h>.
+/
+************************************************************************/
+
+#ifndef FAST_FOURIER_TRANSFORM_PLAN_DEFINED__
+#define FAST_FOURIER_TRANSFORM_PLAN_DEFINED__
+
+#define FFT_PLAN_MAX_PASSES 64
+#define FFT_PLAN_BATCH      8
+
+template <class Real> class FastFourierTransformPlan
+{
+ private:
+  static std::map<int, FastFourierTransformPlan *> Plans;
+
+  int Length;
+  int NumberOfPasses;
+  int Radix[FFT_PLAN_MAX_PASSES];
+  Real *Twiddle[FFT_PLAN_MAX_PASSES];   // twiddles, then the radix roots
+  Real *RealTwiddle;                    // exp(-2 pi i k / 2n), k <= n
+  Real *Butterfly;                      // inputs and outputs of one butterfly
+  Real *Work;                           // scratch for one line
+  Real *Lines;                          // gathered strided lines
+
+  FastFourierTransformPlan(int length);
+  void Pass(int pass, int n, int s, Real *x, Real *y, int direction);
+  void Transform(Real *line, int direction);
+
+ public:
+  ~FastFourierTransformPlan(void);
+
+  /* Returns the plan for complex transforms of this length. */
+
+  static FastFourierTransformPlan *ForLength(int length);
+
+  /* Frees all cached plans. */
+
+  static void DeleteAll(void);
+
+  /* Transforms howmany complex lines; element j of line l starts at
+     element 2*(l*dist + j*stride). */
+
+  int Complex(Real *data, int howmany, int stride, int dist,
+	      int direction);
+
+  /* Transforms howmany real lines of length RealLength (each held in
+     RealLength+2 elements, dist elements apart) to or from their
+     RealLength/2+1 complex coefficients. */
+
+  static int RealToComplex(Real *data, int RealLength, int howmany,
+			   int dist, int direction);
+
+  int ReturnLength(void) { return Length; };
+};
+
+/**********************************************************************/
+
+template <class Real>
+std::map<int, FastFourierTransformPlan<Real> *>
+  FastFourierTransformPlan<Real>::Plans;
+
+template <class Real>
+FastFourierTransformPlan<Real> *
+FastFourierTransformPlan<Real>::ForLength(int length)
+{
+  typename std::map<int, FastFourierTransformPlan *>::iterator it =
+    Plans.find(length);
+  if (it != Plans.end())
+    return it->second;
+  FastFourierTransformPlan *Plan = new FastFourierTransformPlan(length);
+  Plans[length] = Plan;
+  return Plan;
+}
+
+template <class Real>
+void FastFourierTransformPlan<Real>::DeleteAll(void)
+{
+  typename std::map<int, FastFourierTransformPlan *>::iterator it;
+  for (it = Plans.begin(); it != Plans.end(); ++it)
+    delete it->second;
+  Plans.clear();
+}
+
+template <class Real>
+FastFourierTransformPlan<Real>::FastFourierTransformPlan(int length)
+{
+
+  int i, u, r, n, m, left;
+  double angle;
+
+  Length = length;
+  NumberOfPasses = 0;
+  RealTwiddle = NULL;
+
+  /* Factor the length: fours first, then the remaining primes. */
+
+  for (left = Length; left % 4 == 0; left /= 4)
+    Radix[NumberOfPasses++] = 4;
+  for (r = 2; left > 1; )
+    if (left % r == 0) {
+      Radix[NumberOfPasses++] = r;
+      left /= r;
+    } else
+      r = (r == 2) ? 3 : r+2;
+
+  /* Pass p of a length n (what remains of Length after the previous
+     passes) multiplies output u of butterfly j by exp(-2 pi i j u/n),
+     and combines the radix inputs with the radix roots of unity. */
+
+  for (i = 0, n = Length; i < NumberOfPasses; n /= Radix[i], i++) {
+    r = Radix[i];
+    m = n/r;
+    Twiddle[i] = new Real[2*(m*(r-1) + r)];
+    for (int j = 0; j < m; j++)
+      for (u = 1; u < r; u++) {
+	angle = -2.0*M_PI*double(j)*double(u)/double(n);
+	Twiddle[i][2*(j*(r-1)+u-1)  ] = cos(angle);
+	Twiddle[i][2*(j*(r-1)+u-1)+1] = sin(angle);
+      }
+    for (u = 0; u < r; u++) {
+      angle = -2.0*M_PI*double(u)/double(r);
+      Twiddle[i][2*(m*(r-1)+u)  ] = cos(angle);
+      Twiddle[i][2*(m*(r-1)+u)+1] = sin(angle);
+    }
+  }
+
+  int MaxRadix = 1;
+  for (i = 0; i < NumberOfPasses; i++)
+    MaxRadix = max(MaxRadix, Radix[i]);
+  Butterfly = new Real[4*MaxRadix];
+  Work = new Real[2*Length];
+  Lines = new Real[2*Length*FFT_PLAN_BATCH];
+
+}
+
+template <class Real>
+FastFourierTransformPlan<Real>::~FastFourierTransformPlan(void)
+{
+  for (int i = 0; i < NumberOfPasses; i++)
+    delete [] Twiddle[i];
+  delete [] RealTwiddle;
+  delete [] Butterfly;
+  delete [] Work;
+  delete [] Lines;
+}
+
+/* One self-sorting pass: x holds s interleaved transforms of length n,
+   y receives s*r interleaved transforms of length n/r. */
+
+template <class Real>
+void FastFourierTransformPlan<Real>::Pass(int pass, int n, int s, Real *x,
+					  Real *y, int direction)
+{
+
+  int r = Radix[pass], m = n/r, j, q, t, u, index;
+  Real sign = (direction == FFT_FORWARD) ? 1.0 : -1.0;
+  Real *tw = Twiddle[pass], *root = Twiddle[pass] + 2*m*(r-1);
+  Real ar, ai, br, bi, cr, ci, dr, di, wr, wi, sr, si;
+  Real *a = Butterfly, *b = Butterfly + 2*r;
+
+  for (j = 0; j < m; j++)
+    for (q = 0; q < s; q++) {
+
+      Real *in = x + 2*(q + s*j), *out = y + 2*(q + s*r*j);
+
+      if (r == 2) {
+	ar = in[0];  ai = in[1];
+	br = in[2*s*m];  bi = in[2*s*m+1];
+	out[0] = ar + br;  out[1] = ai + bi;
+	a[0] = ar - br;  a[1] = ai - bi;
+	wr = tw[2*j];  wi = sign*tw[2*j+1];
+	out[2*s] = a[0]*wr - a[1]*wi;
+	out[2*s+1] = a[0]*wi + a[1]*wr;
+	continue;
+      }
+
+      if (r == 4) {
+
+	/* (a0 -/+ i a1 - a2 +/- i a3 and so on; -i for the forward sign) */
+
+	ar = in[0] + in[4*s*m];  ai = in[1] + in[4*s*m+1];
+	br = in[0] - in[4*s*m];  bi = in[1] - in[4*s*m+1];
+	cr = in[2*s*m] + in[6*s*m];  ci = in[2*s*m+1] + in[6*s*m+1];
+	dr = in[2*s*m] - in[6*s*m];  di = in[2*s*m+1] - in[6*s*m+1];
+	a[0] = ar + cr;  a[1] = ai + ci;
+	a[2] = br + sign*di;  a[3] = bi - sign*dr;
+	a[4] = ar - cr;  a[5] = ai - ci;
+	a[6] = br - sign*di;  a[7] = bi + sign*dr;
+	out[0] = a[0];  out[1] = a[1];
+	for (u = 1; u < 4; u++) {
+	  wr = tw[2*(3*j+u-1)];  wi = sign*tw[2*(3*j+u-1)+1];
+	  out[2*s*u  ] = a[2*u]*wr - a[2*u+1]*wi;
+	  out[2*s*u+1] = a[2*u]*wi + a[2*u+1]*wr;
+	}
+	continue;
+      }
+
+      /* Any other radix: the direct sum over the radix roots. */
+
+      for (t = 0; t < r; t++) {
+	a[2*t  ] = in[2*s*m*t];
+	a[2*t+1] = in[2*s*m*t+1];
+      }
+      for (u = 0; u < r; u++) {
+	sr = si = 0;
+	for (t = 0, index = 0; t < r; t++, index = (index + u) % r) {
+	  wr = root[2*index];  wi = sign*root[2*index+1];
+	  sr += a[2*t]*wr - a[2*t+1]*wi;
+	  si += a[2*t]*wi + a[2*t+1]*wr;
+	}
+	b[2*u] = sr;  b[2*u+1] = si;
+      }
+      out[0] = b[0];  out[1] = b[1];
+      for (u = 1; u < r; u++) {
+	wr = tw[2*(j*(r-1)+u-1)];  wi = sign*tw[2*(j*(r-1)+u-1)+1];
+	out[2*s*u  ] = b[2*u]*wr - b[2*u+1]*wi;
+	out[2*s*u+1] = b[2*u]*wi + b[2*u+1]*wr;
+      }
+
+    }
+
+}
+
+/* Unnormalized transform of one contiguous line, in place. */
+
+template <class Real>
+void FastFourierTransformPlan<Real>::Transform(Real *line, int direction)
+{
+
+  int i, n = Length, s = 1;
+  Real *x = line, *y = Work, *temp;
+
+  for (i = 0; i < NumberOfPasses; i++) {
+    this->Pass(i, n, s, x, y, direction);
+    n /= Radix[i];
+    s *= Radix[i];
+    temp = x;  x = y;  y = temp;
+  }
+
+  if (x != line)
+    for (i = 0; i < 2*Length; i++)
+      line[i] = x[i];
+
+}
+
+template <class Real>
+int FastFourierTransformPlan<Real>::Complex(Real *data, int howmany,
+					    int stride, int dist, int direction)
+{
+
+  int i, j, l, b, batch;
+  Real scale = (direction == FFT_INVERSE) ? 1.0/Real(Length) : 1.0;
+  Real *line;
+
+  if (stride == 1) {
+    for (l = 0; l < howmany; l++) {
+      line = data + 2*((long) l)*dist;
+      this->Transform(line, direction);
+      if (direction == FFT_INVERSE)
+	for (i = 0; i < 2*Length; i++)
+	  line[i] *= scale;
+    }
+    return SUCCESS;
+  }
+
+  /* Strided lines are gathered a few at a time, so that lines next to
+     each other in memory share the cache lines read. */
+
+  for (l = 0; l < howmany; l += batch) {
+    batch = min(FFT_PLAN_BATCH, howmany - l);
+    for (j = 0; j < Length; j++)
+      for (b = 0; b < batch; b++) {
+	line = data + 2*(((long) l+b)*dist + ((long) j)*stride);
+	Lines[2*(b*Length+j)  ] = line[0];
+	Lines[2*(b*Length+j)+1] = line[1];
+      }
+    for (b = 0; b < batch; b++)
+      this->Transform(Lines + 2*b*Length, direction);
+    for (j = 0; j < Length; j++)
+      for (b = 0; b < batch; b++) {
+	line = data + 2*(((long) l+b)*dist + ((long) j)*stride);
+	line[0] = Lines[2*(b*Length+j)  ]*scale;
+	line[1] = Lines[2*(b*Length+j)+1]*scale;
+      }
+  }
+
+  return SUCCESS;
+
+}
+
+template <class Real>
+int FastFourierTransformPlan<Real>::RealToComplex(Real *data, int RealLength,
+						  int howmany, int dist,
+						  int direction)
+{
+
+  int k, l, M = RealLength/2;
+  Real *X;
+
+  /* Odd lengths: a complex transform of the whole line. */
+
+  if (RealLength % 2 == 1 || RealLength < 2) {
+    FastFourierTransformPlan *Plan = ForLength(RealLength);
+    Real *Full = new Real[2*RealLength];
+    for (l = 0; l < howmany; l++) {
+      X = data + ((long) l)*dist;
+      if (direction == FFT_FORWARD) {
+	for (k = 0; k < RealLength; k++) {
+	  Full[2*k] = X[k];
+	  Full[2*k+1] = 0;
+	}
+	Plan->Transform(Full, direction);
+	for (k = 0; k <= 2*(RealLength/2)+1; k++)
+	  X[k] = Full[k];
+      } else {
+	for (k = 0; k <= RealLength/2; k++) {
+	  Full[2*k] = X[2*k];
+	  Full[2*k+1] = X[2*k+1];
+	}
+	for (k = RealLength/2+1; k < RealLength; k++) {
+	  Full[2*k] = X[2*(RealLength-k)];
+	  Full[2*k+1] = -X[2*(RealLength-k)+1];
+	}
+	Plan->Transform(Full, direction);
+	for (k = 0; k < RealLength; k++)
+	  X[k] = Full[2*k]/Real(RealLength);
+      }
+    }
+    delete [] Full;
+    return SUCCESS;
+  }
+
+  /* Even lengths: the line, read as M complex numbers z = x[2k] +
+     i x[2k+1], is transformed with a complex FFT of length M, and the
+     spectra of the even and odd points are separated from it. */
+
+  FastFourierTransformPlan *Plan = ForLength(M);
+  if (Plan->RealTwiddle == NULL) {
+    Plan->RealTwiddle = new Real[2*(M+1)];
+    for (k = 0; k <= M; k++) {
+      Plan->RealTwiddle[2*k  ] = cos(-M_PI*double(k)/double(M));
+      Plan->RealTwiddle[2*k+1] = sin(-M_PI*double(k)/double(M));
+    }
+  }
+  Real *W = Plan->RealTwiddle;
+  Real zr, zi, yr, yi, er, ei, or_, oi, tr, ti, wr, wi;
+
+  for (l = 0; l < howmany; l++) {
+
+    X = data + ((long) l)*dist;
+
+    if (direction == FFT_FORWARD) {
+
+      Plan->Transform(X, direction);
+
+      /* X[k] = E + W^k O and X[M-k] = conj(E - W^k O), where
+	 E = (Z[k] + conj Z[M-k])/2 and O = -i (Z[k] - conj Z[M-k])/2. */
+
+      zr = X[0];  zi = X[1];
+      X[0] = zr + zi;  X[1] = 0;
+      X[2*M] = zr - zi;  X[2*M+1] = 0;
+      for (k = 1; k <= M/2; k++) {
+	zr = X[2*k];  zi = X[2*k+1];
+	yr = X[2*(M-k)];  yi = X[2*(M-k)+1];
+	er = 0.5*(zr + yr);  ei = 0.5*(zi - yi);
+	or_ = 0.5*(zi + yi);  oi = -0.5*(zr - yr);
+	wr = W[2*k];  wi = W[2*k+1];
+	tr = wr*or_ - wi*oi;  ti = wr*oi + wi*or_;
+	X[2*k] = er + tr;  X[2*k+1] = ei + ti;
+	X[2*(M-k)] = er - tr;  X[2*(M-k)+1] = -(ei - ti);
+      }
+
+    } else {
+
+      /* Z[k] = E + i O, with E = (X[k] + conj X[M-k])/2 and
+	 O = (X[k] - conj X[M-k]) conj(W^k)/2; Z[M-k] = conj E + i conj O.
+	 The imaginary parts of X[0] and X[M] do not contribute to a real
+	 line; they are dropped (the real part of the inverse is kept, as
+	 in the other FFTs, when the spectrum is not quite Hermitian). */
+
+      X[1] = 0;
+      X[2*M+1] = 0;
+      for (k = 0; k <= M/2; k++) {
+	zr = X[2*k];  zi = X[2*k+1];
+	yr = X[2*(M-k)];  yi = X[2*(M-k)+1];
+	er = 0.5*(zr + yr);  ei = 0.5*(zi - yi);
+	tr = 0.5*(zr - yr);  ti = 0.5*(zi + yi);
+	wr = W[2*k];  wi = -W[2*k+1];
+	or_ = tr*wr - ti*wi;  oi = tr*wi + ti*wr;
+	X[2*k] = er - oi;  X[2*k+1] = ei + or_;
+	if (k > 0) {
+	  X[2*(M-k)] = er + oi;  X[2*(M-k)+1] = -ei + or_;
+	}
+      }
+      Plan->Transform(X, direction);
+      for (k = 0; k < 2*M; k++)
+	X[k] /= Real(M);
+
+    }
+
+  }
+
+  return SUCCESS;
+
+}
+
+#endif
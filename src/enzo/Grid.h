@@ -42,7 +42,9 @@ struct HierarchyEntry;
 
 #ifdef TRANSFER
 #include "PhotonPackage.h"
+#include "PhotonPackageStore.h"
 #include "ListOfPhotonsToMove.h"
+#include "PhotonWalkTarget.h"
 #endif /* TRANSFER */
 
 #ifdef NEW_PROBLEM_TYPES
@@ -158,6 +160,9 @@ class grid
 //  Gravity data
 // 
   float *PotentialField;
+  float *PotentialHistory[2];      // PotentialWarmStart: the last two
+  FLOAT  PotentialHistoryTime[2];  //   corrections to the parent's potential
+  float *PotentialFromParent;      //   (and their times, < 0 if none)
   float *AccelerationField[MAX_DIMENSION]; // cell cntr acceleration at n+1/2
   float *GravitatingMassField;
   FLOAT  GravitatingMassFieldLeftEdge[MAX_DIMENSION];
@@ -205,6 +210,8 @@ class grid
 //  Parallel Information
 //
   int ProcessorNumber;
+  float ComputeCost;           // smoothed wall time per step (<0: unknown)
+  double ComputeTimeThisStep;  // wall time measured so far this step
 //
 // Movie Data Format
 //
@@ -232,6 +239,7 @@ class grid
   friend class ActiveParticleType_Skeleton;
   friend class ActiveParticleType_SmartStar;
   friend class ActiveParticleType_SpringelHernquist;
+  friend class BoundaryExchangePlan;
 
 #ifdef NEW_PROBLEM_TYPES
   friend class EnzoProblemType;
@@ -715,6 +723,10 @@ gradient force to gravitational force for one-zone collapse test. */
                               int &NumberOfCells, float &AxialRatio,
                               int &CellsTotal, int &Particles);
 
+/* Add the bytes held by this grid to a memory census (by category). */
+
+   void MemoryCensus(Eint64 Bytes[]);
+
 /* Output grid information (for movie generation). */
 
    int OutputGridMovieData(FILE *Gridfptr, FILE *DMfptr, FILE *Starfptr,
@@ -1090,6 +1102,18 @@ gradient force to gravitational force for one-zone collapse test. */
    int CopyZonesFromGrid(grid *GridOnSameLevel, 
 			 FLOAT EdgeOffset[MAX_DIMENSION]);
 
+/* baryons: record the region CopyZonesFromGrid would copy in the boundary
+            exchange plan being built (see BoundaryExchangePlan.h). */
+
+   int AddToBoundaryExchangePlan(grid *GridOnSameLevel,
+				 FLOAT EdgeOffset[MAX_DIMENSION]);
+
+/* baryons: add the size of the region CopyZonesFromGrid would copy as an
+            edge of the load balance graph (see LoadBalanceGraph.h). */
+
+   int AddToLoadBalanceGraph(grid *GridOnSameLevel,
+			     FLOAT EdgeOffset[MAX_DIMENSION]);
+
   int CopyActiveZonesFromGrid(grid *GridOnSameLevel,
                   FLOAT EdgeOffset[MAX_DIMENSION], int SendField);
 
@@ -1203,13 +1227,43 @@ gradient force to gravitational force for one-zone collapse test. */
    int CopyOverlappingMassField(grid *TargetGrid, 
 				FLOAT EdgeOffset[MAX_DIMENSION]);
 
+/* Gravity: record the region CopyOverlappingMassField would copy in the
+   boundary exchange plan being built (see BoundaryExchangePlan.h). */
+
+   int AddMassFieldToBoundaryExchangePlan(grid *TargetGrid,
+					  FLOAT EdgeOffset[MAX_DIMENSION]);
+
 /* Gravity: Allocate and make initial guess for PotentialField. */
 
    int PreparePotentialField(grid *ParentGrid);
 
 /* Gravity: Allocate and make initial guess for PotentialField. */
 
-   int SolveForPotential(int level, FLOAT PotentialTime = -1);
+   int SolveForPotential(int level, FLOAT PotentialTime = -1,
+			 int NumberOfCycles = 0, float *ResidualSums = NULL,
+			 int *Cycles = NULL);
+
+/* Gravity: Add the squared residual of the potential (and the squared
+   right hand side) over the active zones to ResidualSums. */
+
+   int AddPotentialResidual(float *rhs, float ResidualSums[2]);
+
+/* Gravity: keep the difference between the solved potential and the one
+   interpolated from the parent as the latest of the two time levels used
+   to predict the next initial guess (PotentialWarmStart). */
+
+   int SavePotentialHistory(FLOAT PotentialTime);
+
+/* Gravity: add the correction extrapolated from the last two solutions to
+   the PotentialField interpolated from the parent.  Sets WarmStarted to
+   TRUE if any zone was corrected. */
+
+   int PredictPotentialField(FLOAT PotentialTime, int &WarmStarted);
+
+/* Gravity: copy the potential history from the overlapping (old) grid on
+   the same level (RebuildHierarchy). */
+
+   int CopyPotentialHistoryFromGrid(grid *OldGrid);
 
 /* Gravity: Prepare the Greens Function. */
 
@@ -1219,7 +1273,8 @@ gradient force to gravitational force for one-zone collapse test. */
 /* Gravity: Copy potential/density into/out of FFT regions. */
 
    int PrepareFFT(region *InitialRegion, int Field, int DomainDim[]);
-   int FinishFFT(region *InitialRegion, int Field, int DomainDim[]);
+   int FinishFFT(region *InitialRegion, int Field, int DomainDim[],
+		 int KeepData = FALSE);
 
 /* Gravity: set the potential boundary for isolated BC's */
 
@@ -1665,6 +1720,10 @@ void SortParticlesByNumber();
 void SortActiveParticlesByNumber();
 void SortParticlesByType();
 
+/* Particles: sort particle data by the Morton order of their cells. */
+
+void SortParticlesByCell();
+
 int CreateParticleTypeGrouping(hid_t ptype_dset,
                                hid_t ptype_dspace,
                                hid_t parent_group,
@@ -1689,6 +1748,26 @@ int CreateParticleTypeGrouping(hid_t ptype_dset,
     return ProcessorNumber;
   }
 
+/* Load balancing: add measured wall time to this step, fold the step
+   into the smoothed cost (on the grid's own processor), and access the
+   smoothed cost. */
+
+  void AddComputeTime(double t) { ComputeTimeThisStep += t; };
+
+  void UpdateComputeCost() {
+    if (ProcessorNumber == MyProcessorNumber) {
+      if (ComputeCost < 0)
+	ComputeCost = ComputeTimeThisStep;
+      else
+	ComputeCost = LoadBalancingCostSmoothing * ComputeTimeThisStep +
+	  (1.0 - LoadBalancingCostSmoothing) * ComputeCost;
+    }
+    ComputeTimeThisStep = 0.0;
+  };
+
+  float ReturnComputeCost() { return ComputeCost; };
+  void SetComputeCost(float cost) { ComputeCost = cost; };
+
 /* Send a region from a real grid to a 'fake' grid on another processor. */
 
   int CommunicationSendRegion(grid *ToGrid, int ToProcessor, int SendField, 
@@ -1893,15 +1972,18 @@ int SolvePPM_DE(int CycleNumber, int NumberOfSubgrids,
                 int NumberOfColours, int colnum[],
                 float MinimumSupportEnergyCoefficient);
 
-int xEulerSweep(int k, int NumberOfSubgrids, fluxes *SubgridFluxes[], 
+int xEulerSweep(int kplane, int NumberOfPlanes, int NumberOfSubgrids,
+		fluxes *SubgridFluxes[], 
 		Elong_int GridGlobalStart[], float *CellWidthTemp[], 
 		int GravityOn, int NumberOfColours, int colnum[], float *pressure);
 
-int yEulerSweep(int i, int NumberOfSubgrids, fluxes *SubgridFluxes[], 
+int yEulerSweep(int iplane, int NumberOfPlanes, int NumberOfSubgrids,
+		fluxes *SubgridFluxes[], 
 		Elong_int GridGlobalStart[], float *CellWidthTemp[], 
 		int GravityOn, int NumberOfColours, int colnum[], float *pressure);
 
-int zEulerSweep(int j, int NumberOfSubgrids, fluxes *SubgridFluxes[], 
+int zEulerSweep(int jplane, int NumberOfPlanes, int NumberOfSubgrids,
+		fluxes *SubgridFluxes[], 
 		Elong_int GridGlobalStart[], float *CellWidthTemp[], 
 		int GravityOn, int NumberOfColours, int colnum[], float *pressure);
 
@@ -3058,7 +3140,8 @@ int zEulerSweep(int j, int NumberOfSubgrids, fluxes *SubgridFluxes[],
 
   int MoveParticlesFOF(int level, FOF_particle_data* &P, 
 		       int &Index, FOFData AllVars, float VelocityUnits, 
-		       double MassUnits, int CopyDirection);
+		       double MassUnits, int CopyDirection, 
+		       int KeepParticles = FALSE);
 
   int InterpolateParticlesToGrid(FOFData *D);
 
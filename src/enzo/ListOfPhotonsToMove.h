@@ -5,7 +5,7 @@
 *****************************/ 
 
 struct ListOfPhotonsToMove {
-  PhotonPackageEntry  *PhotonPackage;
+  PhotonPackageEntry  PhotonPackage;        // a copy; removed from its grid
   ListOfPhotonsToMove *NextPackageToMove;
   grid *FromGrid;
   grid *ToGrid;  
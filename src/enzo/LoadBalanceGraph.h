@@ -0,0 +1,98 @@
+/***********************************************************************
+/
+/  LOAD BALANCE GRAPH CLASS
+/
+/  date:       October, 2026
+/
+/  PURPOSE:
+/    A weighted graph of the grids on one level, used by the graph
+/    partitioning load balancer (LoadBalancing = 5).
+/
+/    Each vertex is a grid, weighted by its work.  Each edge joins two
+/    siblings, weighted by the bytes of ghost zones they exchange in a
+/    step.  Each vertex can also be tied to a fixed processor (the one
+/    holding its parent grid) with an anchor weight, which is the
+/    traffic between the grid and its parent.
+/
+/    The edges are recorded by running the usual CheckForOverlap loop
+/    over the sibling lists with grid::AddToLoadBalanceGraph as the copy
+/    function.  Each processor records the edges of its own grids, and
+/    EndRecording shares them, so that every processor holds the whole
+/    graph and computes the same partition.
+/
+/    Partition is a multilevel k-way partitioner: the graph is
+/    coarsened by heavy-edge matching (only within a part, so the
+/    current assignment carries down), the coarsest graph starts from
+/    the current assignment, and each level on the way back up is
+/    balanced and then refined by moving boundary vertices to the part
+/    they are most connected to.
+/
+************************************************************************/
+
+#ifndef LOAD_BALANCE_GRAPH_DEFINED__
+#define LOAD_BALANCE_GRAPH_DEFINED__
+
+#include <map>
+#include <vector>
+
+struct LoadBalanceGraphEdge {
+  int ToIndex;
+  int FromIndex;
+  float Weight;
+};
+
+class LoadBalanceGraph
+{
+ private:
+
+  /* Compressed adjacency lists (symmetric, no self edges). */
+
+  int NumberOfVertices;
+  std::vector<float> VertexWork;
+  std::vector<int> AdjacencyStart;
+  std::vector<int> Adjacency;
+  std::vector<float> EdgeWeight;
+
+  std::vector<int> Anchor;          // fixed processor for each vertex (or -1)
+  std::vector<float> AnchorWeight;  // cut weight if not placed on Anchor
+
+  /* Only used while recording. */
+
+  std::map<grid *, int> GridIndex;
+  std::vector<LoadBalanceGraphEdge> RecordedEdges;
+
+  static LoadBalanceGraph *CurrentGraph;
+
+  void BuildAdjacency(std::vector<LoadBalanceGraphEdge> &Edges);
+  LoadBalanceGraph *Coarsen(std::vector<int> &Part, std::vector<int> &Map);
+  void Balance(std::vector<int> &Part, int NumberOfParts, float MaxWork);
+  void Refine(std::vector<int> &Part, int NumberOfParts, float MaxWork);
+  float Connectivity(int v, std::vector<int> &Part,
+		     std::map<int, float> &PartConnection);
+
+ public:
+  LoadBalanceGraph(void);
+
+  /* The graph that the grid recording method adds to. */
+
+  static LoadBalanceGraph *RecordingGraph(void) { return CurrentGraph; };
+
+  void BeginRecording(HierarchyEntry *Grids[], int NumberOfGrids);
+  void AddEdge(grid *ToGrid, grid *FromGrid, float Weight);
+  void EndRecording(void);
+
+  void SetVertexWork(int v, float Work) { VertexWork[v] = Work; };
+  void SetAnchor(int v, int Processor, float Weight)
+    { Anchor[v] = Processor; AnchorWeight[v] = Weight; };
+
+  /* Partitions into NumberOfParts, starting from (and overwriting)
+     Part.  The work of each part stays below Tolerance times the
+     mean, where the vertex sizes allow it. */
+
+  void Partition(int NumberOfParts, float Tolerance, int *Part);
+
+  float ReturnCut(int *Part);
+  int ReturnNumberOfEdges(void) { return Adjacency.size()/2; };
+};
+
+#endif
@@ -0,0 +1,52 @@
+/***********************************************************************
+/
+/  MEMORY CENSUS DEFINITIONS
+/
+/  date:       October, 2026
+/
+/  PURPOSE:
+/    Categories and phases of the per-processor memory accounting (see
+/    MemoryCensus.C).  A sample taken with MemoryCensus(..., phase)
+/    closes the interval since the previous sample, and that phase
+/    keeps the largest value of each category seen at its samples.
+/
+************************************************************************/
+
+#ifndef MEMORY_CENSUS_DEFINED__
+#define MEMORY_CENSUS_DEFINED__
+
+/* Categories (bytes).  The first ones are counted from the data
+   structures; the resident size is read from the operating system and
+   the untracked memory is the difference. */
+
+#define MEMORY_BARYON_FIELDS      0
+#define MEMORY_OLD_BARYON_FIELDS  1
+#define MEMORY_PARTICLES          2
+#define MEMORY_FLUXES             3
+#define MEMORY_GRAVITY            4
+#define MEMORY_PHOTONS            5
+#define MEMORY_COMMUNICATION      6
+#define MEMORY_SCRATCH            7
+#define MEMORY_HIERARCHY          8
+#define MEMORY_UNTRACKED          9
+#define MEMORY_RESIDENT          10
+#define MEMORY_PEAK_RESIDENT     11
+#define NUMBER_OF_MEMORY_CATEGORIES 12
+
+#define NUMBER_OF_TRACKED_MEMORY_CATEGORIES 9
+
+/* Phases.  The EvolveLevel ones are sampled once per level timestep,
+   in this order. */
+
+#define MEMORY_PHASE_SETUP        0   // timestep, star and particle init
+#define MEMORY_PHASE_RADIATION    1   // radiative transfer
+#define MEMORY_PHASE_GRAVITY      2   // fluxes, density field, potential
+#define MEMORY_PHASE_HYDRO        3   // hydro and chemistry
+#define MEMORY_PHASE_PARTICLES    4   // particle push, star feedback
+#define MEMORY_PHASE_BOUNDARY     5   // boundaries, update from finer grids
+#define MEMORY_PHASE_REBUILD      6   // RebuildHierarchy
+#define MEMORY_PHASE_OUTPUT       7   // data output
+#define MEMORY_PHASE_ANALYSIS     8   // inline halo finder
+#define NUMBER_OF_MEMORY_PHASES   9
+
+#endif
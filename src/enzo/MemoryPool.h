@@ -138,6 +138,9 @@ namespace MPool
     // Checks if the pointer is in the memory pool
     bool IsValidPointer(void* Pointer);
 
+    // Returns the number of bytes allocated from the OS
+    size_t GetTotalMemoryPoolSize(void) { return TotalMemoryPoolSize; }
+
   };
 }
 
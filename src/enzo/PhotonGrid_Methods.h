@@ -29,12 +29,12 @@ void DeleteSubgridMarker() { delete [] SubgridMarker; SubgridMarker = NULL; };
 
    int ReturnNumberOfPhotonPackages(void) {return NumberOfPhotonPackages;};
 
-/* Photons: return PhotonPackage pointer. */
+/* Photons: return the stores of photon packages. */
 
-   PhotonPackageEntry *ReturnPhotonPackagePointer(void) 
+   PhotonPackageStore *ReturnPhotonPackageStore(void) 
    {return PhotonPackages;};
 
-   PhotonPackageEntry *ReturnPausedPackagePointer(void) 
+   PhotonPackageStore *ReturnPausedPackageStore(void) 
    {return PausedPhotonPackages;};
 
 /* Photons: set number of photons. */
@@ -49,7 +49,7 @@ void DeleteSubgridMarker() { delete [] SubgridMarker; SubgridMarker = NULL; };
 
    int DeletePhotonPackages(int DeleteHeadPointer=FALSE);
 
-/* sort photon linked lists */
+/* sort photon packages */
 
    int PhotonSortLinkedLists(void);
 
@@ -79,36 +79,38 @@ int RadiativeTransferLWShielding(PhotonPackageEntry **PP, FLOAT &dP,
 				 FLOAT thisDensity, FLOAT ddr, 
 				 int cellindex,  float LengthUnits,
 				 int kdissH2INum, int TemperatureField,
-				 float geo_correction);
+				 float geo_correction, float **Rates);
 
 int RadiativeTransferLW(PhotonPackageEntry **PP, FLOAT &dP,
 			int cellindex, float tau, FLOAT photonrate, 
-			float geo_correction, int kdissH2INum);
+			float geo_correction, int kdissH2INum, float **Rates);
 
 int RadiativeTransferH2II(PhotonPackageEntry **PP,
 			  int cellindex, float tau, FLOAT photonrate, 
-			  float geo_correction, int kdissH2IINum);
+			  float geo_correction, int kdissH2IINum, float **Rates);
 
 
 int RadiativeTransferIR(PhotonPackageEntry **PP, FLOAT &dP,
 			int cellindex, float tau, FLOAT photonrate, 
 			FLOAT *excessrate, float geo_correction, 
-			int kphHMNum, int gammaNum);
+			int kphHMNum, int gammaNum, float **Rates);
 
 int RadiativeTransferIonization(PhotonPackageEntry **PP, FLOAT *dPi, int cellindex, 
 				int species, float tau, FLOAT photonrate, 
 				FLOAT *excessrate, float geo_correction,
-				const int *kphNum, int gammaNum);
+				const int *kphNum, int gammaNum, float **Rates);
 
 int RadiativeTransferXRays(PhotonPackageEntry **PP, FLOAT *dPi, int cellindex, 
 			   int species, FLOAT ddr, float tau, FLOAT geo_correction,
 			   FLOAT photonrate, FLOAT *excessrate, float *ion_factor2,
-			   float heat_factor, const int *kphNum, int gammaNum);
+			   float heat_factor, const int *kphNum, int gammaNum,
+			   float **Rates);
 
 int RadiativeTransferComptonHeating(PhotonPackageEntry **PP, FLOAT *dPi, int cellindex, 
 				    float LengthUnits, FLOAT photonrate, 
 				    int TemperatureField, FLOAT ddr, double dN, 
-				    float geo_correction, int gammaNum);
+				    float geo_correction, int gammaNum,
+				    float **Rates);
 
 /* Functions to calculate the H2II cross section */
 float LookUpCrossSectionH2II(float hnu, float T);
@@ -146,8 +148,7 @@ float LookUpCrossSectionH2II(float hnu, float T);
 /* Communicate photon packages when rebuilding hierarchy */
 
   int CommunicationSendPhotonPackages(grid *ToGrid, int ToProcessor,
-				      int ToNumber, int FromNumber, 
-				      PhotonPackageEntry **ToPP);
+				      int ToNumber, int FromNumber);
 
   int CommunicationSendSubgridMarker(grid *ToGrid, int ToProcessor);
 
@@ -158,63 +159,49 @@ int TransportPhotonPackages(int level, int finest_level,
 			    int GridNum, grid **Grids0, int nGrids0, 
 			    grid *ParentGrid, grid *CurrentGrid);
 
+/* The photon package loop of TransportPhotonPackages: walk the
+   packages of the store of Target (or PhotonPackages without a
+   target) one by one; they end up in Finished, Paused or
+   PhotonsToMove, or are deleted */
+
+int TransportPhotonStore(PhotonWalkTarget *Target,
+			 PhotonPackageStore *Finished,
+			 PhotonPackageStore *Paused,
+			 ListOfPhotonsToMove **PhotonsToMove, int level,
+			 int GridNum, grid **Grids0, int nGrids0,
+			 grid *ParentGrid, grid *CurrentGrid,
+			 float LightCrossingTime, float LightSpeed,
+			 float MinimumPhotonFlux, FLOAT EndTime,
+			 const float *DomainWidth, int &tcount,
+			 int &dcount, int &pcount, int &trcount);
+
+/* Threaded transport: walk the ionizing packages in chunks with
+   OpenMP tasks (see RadiativeTransferThreadedChunkSize) */
+
+int TransportPhotonChunks(ListOfPhotonsToMove **PhotonsToMove, int level,
+			  int GridNum, grid **Grids0, int nGrids0,
+			  grid *ParentGrid, grid *CurrentGrid,
+			  float LightCrossingTime, float LightSpeed,
+			  float MinimumPhotonFlux, FLOAT EndTime,
+			  const float *DomainWidth, int &tcount,
+			  int &dcount, int &pcount, int &trcount);
+
 int ElectronFractionEstimate(float dt);
 int RadiationPresent(void) { return HasRadiation; }
 void SetRadiation(char value) { HasRadiation = value; }
 
 void InitializePhotonPackages(void) {
-  if (PhotonPackages == NULL) {
-    PhotonPackages = new PhotonPackageEntry;
-    PhotonPackages->NextPackage     = NULL;
-    PhotonPackages->PreviousPackage = NULL;
-  }
-  if (FinishedPhotonPackages == NULL) {
-    FinishedPhotonPackages = new PhotonPackageEntry;
-    FinishedPhotonPackages->NextPackage = NULL;
-    FinishedPhotonPackages->PreviousPackage = NULL;
-  }    
-  if (PausedPhotonPackages == NULL) {
-    PausedPhotonPackages = new PhotonPackageEntry;
-    PausedPhotonPackages->NextPackage = NULL;
-    PausedPhotonPackages->PreviousPackage = NULL;
-  }
-  return;
-}
-
-void ResetPhotonPackagePointer(void) {
-  PhotonPackages->NextPackage     = NULL;
-  PhotonPackages->PreviousPackage = NULL;
-  PhotonPackages->Photons         = 1.;
-  PhotonPackages->Type            = 0;          
-  PhotonPackages->Energy          = 0.;        
-  PhotonPackages->EmissionTimeInterval= 0.;      
-  PhotonPackages->EmissionTime    = 0.;  
-  PhotonPackages->CurrentTime     = 0.;   
-  PhotonPackages->Radius          = 0.;        
-  PhotonPackages->ipix            = 0;         
-  PhotonPackages->level           = 0;        
+  if (PhotonPackages == NULL)
+    PhotonPackages = new PhotonPackageStore;
+  if (FinishedPhotonPackages == NULL)
+    FinishedPhotonPackages = new PhotonPackageStore;
+  if (PausedPhotonPackages == NULL)
+    PausedPhotonPackages = new PhotonPackageStore;
   return;
 }
 
 int MoveFinishedPhotonsBack(void) {
-
-  PhotonPackageEntry *FPP = FinishedPhotonPackages->NextPackage;
-
-  if (FPP != NULL) {
-
-    // Find the end of the PhotonPackages list
-    PhotonPackageEntry *PP = PhotonPackages;
-    while (PP->NextPackage != NULL)
-      PP = PP->NextPackage;
-
-    FPP->PreviousPackage = PP;
-    PP->NextPackage = FPP;
-
-  }
-
-  FinishedPhotonPackages->PreviousPackage = NULL;
-  FinishedPhotonPackages->NextPackage = NULL;
-
+  PhotonPackages->MoveAll(FinishedPhotonPackages);
   return SUCCESS;
 }
 
@@ -236,8 +223,10 @@ float ReturnTotalNumberOfRaySegments(int RaySegNum) {
 #define NO_DEBUG
 #ifdef DEBUG
 int ErrorCheckSource(void) {
+  int i;
   PhotonPackageEntry *PP;
-  for (PP = PhotonPackages->NextPackage; PP; PP = PP->NextPackage) {
+  for (i = 0, PP = PhotonPackages->Packages; i < PhotonPackages->Number;
+       i++, PP++) {
     if (PP->CurrentSource != NULL) {
       if ((PP->CurrentSource->LeafID < 0 ||
 	   PP->CurrentSource->LeafID > 10000) &&
@@ -247,7 +236,8 @@ int ErrorCheckSource(void) {
       }
     }
   }
-  for (PP = FinishedPhotonPackages->NextPackage; PP; PP = PP->NextPackage) {
+  for (i = 0, PP = FinishedPhotonPackages->Packages;
+       i < FinishedPhotonPackages->Number; i++, PP++) {
     if (PP->CurrentSource != NULL) {
       if ((PP->CurrentSource->LeafID < 0 ||
 	   PP->CurrentSource->LeafID > 10000) &&
@@ -263,12 +253,8 @@ int ErrorCheckSource(void) {
 int ErrorCheckPhotonNumber(int level) {
   if (MyProcessorNumber != ProcessorNumber)
     return SUCCESS;
-  int count = 0, fcount = 0;
-  PhotonPackageEntry *PP;
-  for (PP = PhotonPackages->NextPackage; PP; PP = PP->NextPackage)
-    count++;
-  for (PP = FinishedPhotonPackages->NextPackage; PP; PP = PP->NextPackage)
-    fcount++;
+  int count = PhotonPackages->Number;
+  int fcount = FinishedPhotonPackages->Number;
   if (count+fcount != NumberOfPhotonPackages) {
     printf("level %"ISYM", grid %"ISYM" (%x)\n", level, this->ID, this);
     printf("-> Mismatch between photon count (%"ISYM", %"ISYM") and "
@@ -280,32 +266,15 @@ int ErrorCheckPhotonNumber(int level) {
 }
 
 int ReturnFinishedPhotonCount(void) {
-  int result = 0;
   if (MyProcessorNumber != ProcessorNumber)
-    return result;
-  PhotonPackageEntry *PP = FinishedPhotonPackages->NextPackage;
-  while (PP != NULL) {
-    result++;
-    PP = PP->NextPackage;
-  }
-  return result;
+    return 0;
+  return FinishedPhotonPackages->Number;
 }
 
 int ReturnRealPhotonCount(void) {
-  int result = 0;
   if (MyProcessorNumber != ProcessorNumber)
-    return result;
-  PhotonPackageEntry *PP = PhotonPackages->NextPackage;
-  while (PP != NULL) {
-    result++;
-    PP = PP->NextPackage;
-  }
-  PP = FinishedPhotonPackages->NextPackage;
-  while (PP != NULL) {
-    result++;
-    PP = PP->NextPackage;
-  }
-  return result;
+    return 0;
+  return PhotonPackages->Number + FinishedPhotonPackages->Number;
 }
 #endif /* DEBUG */
 /************************************************************************
@@ -317,14 +286,7 @@ int CountPhotonNumber(void) {
   if (MyProcessorNumber != ProcessorNumber)
     return 0;
 
-  int nphotons = 0;
-  PhotonPackageEntry *PP = PhotonPackages->NextPackage;
-  while (PP != NULL) {
-    nphotons++;
-    PP = PP->NextPackage;
-  }
-
-  return nphotons;
+  return PhotonPackages->Number;
 
 }
 
@@ -445,13 +407,15 @@ int TraceRay(int NumberOfSegments,
 	     FLOAT dr[],
 	     long cindex[], int ci[], int cj[], int ck[]);
 
-/* Walk Photon Package one by one */ 
+/* Walk Photon Package one by one.  With a Target, the rates, split
+   packages and I-front maximum go there instead of into the grid. */
 
 int WalkPhotonPackage(PhotonPackageEntry **PP, 
 		      grid **MoveToGrid, grid *ParentGrid, grid *CurrentGrid,
 		      grid **Grids0, int nGrids0, int &DeleteMe, int &PauseMe, 
 		      int &DeltaLevel, float LightCrossingTime,float LightSpeed,
-		      int level, float MinimumPhotonFlux);
+		      int level, float MinimumPhotonFlux,
+		      PhotonWalkTarget *Target);
 
 int FindPhotonNewGrid(int cindex, FLOAT *r, double *u, int *g,
 		      PhotonPackageEntry* &PP,
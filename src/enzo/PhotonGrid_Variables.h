@@ -3,14 +3,14 @@
 int    NumberOfPhotonPackages;
 //int    NumberOfRenderingPackages;
 
-//  start pointer for linked list of packages
-PhotonPackageEntry *PhotonPackages;
+// packages that are being traced (see PhotonPackageStore.h)
+PhotonPackageStore *PhotonPackages;
 
-// linked list of packages with its work already finished
-PhotonPackageEntry *FinishedPhotonPackages;  
+// packages with their work already finished
+PhotonPackageStore *FinishedPhotonPackages;
 
-// linked list of packages that are "paused", waiting to be merged
-PhotonPackageEntry *PausedPhotonPackages;
+// packages that are "paused", waiting to be merged
+PhotonPackageStore *PausedPhotonPackages;
 
 // linked list of packages used for projections or volume renderings
 //PhotonPackageEntry *RenderingPhotonPackages;
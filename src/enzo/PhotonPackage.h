@@ -8,8 +8,11 @@
 /                Converted into a poor man's class with everything 
 /                public.  I need a constructor/destructor to use the
 /                MemoryPool to avoid memory fragmentation.
+/  modified2:  October, 2026
+/                The packages are stored in arrays (PhotonPackageStore.h)
+/                instead of linked lists.
 /
-/  PURPOSE: Constructs a Linked List of Photon Packages including data
+/  PURPOSE: Data of one photon package (ray)
 /
 ************************************************************************/
 #ifndef __PHOTONPACKAGE_H
@@ -20,8 +23,6 @@
 class PhotonPackageEntry
 {
 public:
-  PhotonPackageEntry *NextPackage; // Next Link
-  PhotonPackageEntry *PreviousPackage; // Previous Link
   SuperSourceEntry *CurrentSource;  // Currently used (super)source  
   float Photons;                // number of photons in package
   int   Type;                   // 0 = HI, 1=HeI, 2=HeII, 3=H2I_LW, 4=Xray
@@ -37,12 +38,10 @@ public:
   FLOAT SourcePosition[3];      // Position where package was emitted
   float SourcePositionDiff;     // Radius at which it was radiated (0 = pt src)
 
-  /* CONSTRUCTOR AND DESTRUCTOR */
+  /* CONSTRUCTOR */
 
   PhotonPackageEntry(void);
 
-  virtual ~PhotonPackageEntry(void) {};
-
   /* Overloaded new/delete to use the memory pool, if requested */
 
 #ifdef MEMORY_POOL
@@ -0,0 +1,78 @@
+/***********************************************************************
+/
+/  PHOTON PACKAGE STORE
+/
+/  date:       October, 2026
+/
+/  PURPOSE:
+/    Contiguous storage for the photon packages of a grid.  Each grid
+/    has three stores: the packages that are still being traced, the
+/    ones that have finished for this timestep, and the paused ones
+/    that are waiting to be merged.
+/
+/    A package is addressed by its index (or a pointer into Packages).
+/    Appending never moves the packages as long as there is room
+/    (see Reserve), but Remove fills the hole with the last packages,
+/    so indices and pointers past the removed ones are only valid
+/    until the next removal.  Code that has to keep a package across
+/    removals, e.g. the list of photons to move, keeps a copy.
+/
+************************************************************************/
+
+#ifndef PHOTON_PACKAGE_STORE_DEFINED__
+#define PHOTON_PACKAGE_STORE_DEFINED__
+
+#include "PhotonPackage.h"
+
+struct PhotonBuffer;
+
+class PhotonPackageStore
+{
+public:
+  PhotonPackageEntry *Packages;  // Packages[0 .. Number-1]
+  int Number;                    // number of packages
+  int Size;                      // allocated length of Packages
+
+  /* CONSTRUCTOR AND DESTRUCTOR */
+
+  PhotonPackageStore(void);
+  ~PhotonPackageStore(void);
+
+  /* Make room for n more packages, so that the next n appends do not
+     move the packages. */
+
+  void Reserve(int n);
+
+  /* Append a package with default values, or a copy of PP, and return
+     a pointer to it */
+
+  PhotonPackageEntry *Append(void);
+  PhotonPackageEntry *Append(const PhotonPackageEntry &PP);
+
+  /* Remove the n packages starting at index.  The last packages of
+     the store are moved into their place. */
+
+  void Remove(int index, int n = 1);
+
+  /* Append all packages of From and empty it */
+
+  void MoveAll(PhotonPackageStore *From);
+
+  /* Sort by source, level, pixel number and type (compare_ss) */
+
+  void Sort(void);
+
+  /* Copy the packages to and from the MPI buffers */
+
+  void Pack(PhotonBuffer *buffer);
+  void Unpack(PhotonBuffer *buffer, int n);
+
+  void Clear(void) { Number = 0; };
+  void Free(void);
+
+};
+
+void PackPhotonBuffer(const PhotonPackageEntry &PP, PhotonBuffer &buffer);
+void UnpackPhotonBuffer(const PhotonBuffer &buffer, PhotonPackageEntry &PP);
+
+#endif
@@ -0,0 +1,30 @@
+/***********************************************************************
+/
+/  PHOTON WALK TARGET
+/
+/  date:       October, 2026
+/
+/  PURPOSE:
+/    What grid::WalkPhotonPackage changes in the grid besides the
+/    photon package itself: the rate fields it deposits into, the store
+/    that receives the children of split packages, the maximum
+/    photo-ionization rate in the I-front and the number of new
+/    packages.  Without a target the walk changes the grid directly.
+/    The threaded transport gives every chunk of packages its own
+/    target, with buffers in place of the rate fields (see
+/    Grid_TransportPhotonChunks.C).
+/
+************************************************************************/
+
+#ifndef PHOTON_WALK_TARGET_DEFINED__
+#define PHOTON_WALK_TARGET_DEFINED__
+
+struct PhotonWalkTarget {
+  float *Rates[MAX_NUMBER_OF_BARYON_FIELDS];	// indexed like BaryonField
+  PhotonPackageStore *Store;
+  float MaximumkphIfront;
+  int IndexOfMaximumkph;
+  int NumberOfNewPackages;
+};
+
+#endif
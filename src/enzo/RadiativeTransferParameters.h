@@ -112,6 +112,24 @@ EXTERN char *RadiativeTransferTraceSpectrumTable;
 
 EXTERN int RadiativeTransferLoadBalance;
 
+/* Threaded ray tracing (OpenMP builds): grids are traced by different
+   threads, and the ionizing packages of a grid are cut into chunks of
+   RadiativeTransferThreadedChunkSize packages that are traced by
+   different threads into their own rate field buffers, which are
+   added in chunk order (0 = whole grids only). */
+
+EXTERN int RadiativeTransferThreaded;
+EXTERN int RadiativeTransferThreadedChunkSize;
+
+/* Exchange the rays between processors while tracing: rays that leave
+   a processor are sent in messages of RadiativeTransferRayExchange-
+   BatchSize photons as soon as they fill, and termination is detected
+   with a token passed around the processors, instead of alternating
+   tracing and global exchanges. */
+
+EXTERN int RadiativeTransferAsyncRayExchange;
+EXTERN int RadiativeTransferRayExchangeBatchSize;
+
 /* Flux threshold when rays are deleted in units of the UV background
    flux (RadiationFieldType > 0) */
 
@@ -0,0 +1,113 @@
+/***********************************************************************
+/
+/  ROOT GRAVITY CONTEXT CLASS
+/
+/  date:       October, 2026
+/
+/  PURPOSE:
+/    The state of the root grid gravity solve (see
+/    ComputePotentialFieldLevelZero) that only depends on how the root
+/    grid is partitioned: the transformed Green's function, the FFT
+/    regions of the root grids and their data, and the work arrays of
+/    the parallel FFT (the pencil data and the transpose message
+/    buffers).
+/
+/    The context records the partition (processor and extent of every
+/    root grid) it was built for.  ForRootGrids compares it with the
+/    current one and starts afresh only if it differs, e.g. after the
+/    root grids have been load balanced.
+/
+/    Work arrays are kept in a free list by size.  A transpose takes
+/    the array for its destination from the list and returns the
+/    source array to it, so after the first solve the same few arrays
+/    are passed around and nothing is allocated.
+/
+************************************************************************/
+
+#ifndef ROOT_GRAVITY_CONTEXT_DEFINED__
+#define ROOT_GRAVITY_CONTEXT_DEFINED__
+
+#include <map>
+#include <vector>
+
+#define ROOT_GRAVITY_MAX_FREE_BUFFERS 8
+
+/* Where one root grid is: its processor and extent. */
+
+struct RootGravityGrid {
+  int Processor;
+  int Dimension[MAX_DIMENSION];
+  FLOAT LeftEdge[MAX_DIMENSION];
+};
+
+class RootGravityContext
+{
+ private:
+  std::vector<RootGravityGrid> Partition;
+
+  region *GridRegion;            // PrepareFFT regions (Data kept)
+  int NumberOfGridRegions;
+  region *GreensRegion;          // Green's function, in k-space
+  int NumberOfGreensRegions;
+
+  std::multimap<long, float *> FreeBuffers;
+  float *TransposeBuffer[2];     // send and receive
+  long TransposeBufferSize[2];
+
+  long BuffersReused;
+
+  static RootGravityContext *Current;
+
+  RootGravityContext(void);
+  void Reset(void);
+  int SamePartition(HierarchyEntry *Grids[], int NumberOfGrids);
+
+ public:
+  ~RootGravityContext(void);
+
+  /* Returns the context for the current root grids, emptied first if
+     they have been partitioned differently. */
+
+  static RootGravityContext *ForRootGrids(HierarchyEntry *Grids[],
+					  int NumberOfGrids);
+
+  /* Frees everything. */
+
+  static void DeleteAll(void);
+
+  /* Work arrays for the parallel FFT.  GetBuffer returns an array of
+     size floats (zeroed if Zero is set); ReleaseBuffer takes back one
+     obtained from it or from new[].  Without a context they fall back
+     to new[] and delete[]. */
+
+  static float *GetBuffer(long size, int Zero);
+  static void ReleaseBuffer(float *data, long size);
+
+  /* Message buffer 0 (send) or 1 (receive) of at least size floats,
+     or NULL without a context. */
+
+  static float *GetTransposeBuffer(int which, long size);
+
+  /* The root grid FFT regions, with the data of the last solve. */
+
+  region *ReturnGridRegions(void) { return GridRegion; };
+
+  /* The Green's function, once set (it is then owned by the context). */
+
+  int HasGreensFunction(void) { return (GreensRegion != NULL); };
+  void SetGreensFunction(region *Greens, int NumberOfRegions)
+    { GreensRegion = Greens; NumberOfGreensRegions = NumberOfRegions; };
+  region *ReturnGreensFunction(int *NumberOfRegions)
+    { *NumberOfRegions = NumberOfGreensRegions; return GreensRegion; };
+
+  /* Bytes held on this processor, and arrays reused since the last
+     call (for the performance counters). */
+
+  long ReturnBytesHeld(void);
+  static long ReturnCurrentBytesHeld(void)
+    { return (Current != NULL) ? Current->ReturnBytesHeld() : 0; };
+  long ReturnBuffersReused(void)
+    { long n = BuffersReused; BuffersReused = 0; return n; };
+};
+
+#endif
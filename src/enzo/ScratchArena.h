@@ -0,0 +1,81 @@
+/***********************************************************************
+/
+/  SCRATCH ARENA CLASS
+/
+/  date:       October, 2026
+/
+/  PURPOSE:
+/    Per-thread scratch memory for the short-lived work arrays used by
+/    the hydro sweeps.  The sweeps allocate ~30 slice-sized temporaries
+/    for every slice of every grid; rather than calling new/delete each
+/    time, they take them from one contiguous block owned by the
+/    calling thread:
+/
+/      ScratchArena &Scratch = ScratchArena::ThisThread();
+/      long ScratchMark = Scratch.Mark();
+/      float *dslice = Scratch.Allocate(size);
+/      ...
+/      Scratch.Release(ScratchMark);
+/
+/    Allocations are released in stack order.  A request that does not
+/    fit in the block is served from the heap (an overflow block); when
+/    the outermost mark is released the block is regrown to the peak
+/    demand seen, so after the first slice of the largest grid all
+/    further requests are served without touching the heap.
+/
+************************************************************************/
+
+#ifndef SCRATCH_ARENA_DEFINED__
+#define SCRATCH_ARENA_DEFINED__
+
+#define MAX_SCRATCH_ARENAS          256
+#define MAX_SCRATCH_OVERFLOW_BLOCKS 128
+
+/* Allocations are padded to a multiple of this many floats (64 bytes
+   in double precision) so that consecutive arrays stay aligned. */
+
+#define SCRATCH_ARENA_ALIGNMENT 8
+
+class ScratchArena
+{
+ private:
+  float *Block;            // contiguous scratch block
+  long BlockSize;          // size of Block (in floats)
+  long Used;               // floats handed out from Block
+  long Demand;             // floats handed out in total (Block + overflow)
+  long PeakDemand;         // largest Demand since the block was last sized
+  int NumberOfOverflowBlocks;
+  float *OverflowBlock[MAX_SCRATCH_OVERFLOW_BLOCKS];
+  long OverflowStart[MAX_SCRATCH_OVERFLOW_BLOCKS];  // Demand when allocated
+  long AllocationsAvoided; // requests served from Block
+  long HeapAllocations;    // overflow blocks and block (re)sizes
+
+  void ResizeBlock(long NewSize);
+
+ public:
+  ScratchArena(void);
+  ~ScratchArena(void);
+
+  /* Returns the arena belonging to the calling (OpenMP) thread. */
+
+  static ScratchArena &ThisThread(void);
+
+  /* Returns the number of heap allocations avoided by all arenas since
+     the last call, and resets the counters. */
+
+  static long CollectAllocationsAvoided(void);
+
+  /* Returns the size of all arena blocks (in floats). */
+
+  static long TotalBlockSize(void);
+
+  float *Allocate(long size, bool zero = false);
+  long Mark(void) { return Demand; };
+  void Release(long mark);
+
+  long ReturnBlockSize(void) { return BlockSize; };
+  long ReturnAllocationsAvoided(void) { return AllocationsAvoided; };
+  long ReturnHeapAllocations(void) { return HeapAllocations; };
+};
+
+#endif
@@ -48,6 +48,17 @@ EXTERN int PreviousMaxTask;
 EXTERN int LoadBalancingMinLevel;
 EXTERN int LoadBalancingMaxLevel;
 
+/* Balance on the measured wall time of each grid (smoothed over steps
+   with weight LoadBalancingCostSmoothing) rather than its cell count. */
+
+EXTERN int LoadBalancingUseMeasuredCost;
+EXTERN float LoadBalancingCostSmoothing;
+
+/* Exchange sibling ghost zones and mass fields with one message per pair
+   of processors, using plans cached between hierarchy rebuilds. */
+
+EXTERN int CoalescedSiblingExchange;
+
 /* FileDirectedOutput checks for file existence: 
    stopNow (writes, stops),   outputNow, subgridcycleCount */
 EXTERN int FileDirectedOutput;
@@ -100,6 +111,35 @@ EXTERN int extract;
 EXTERN int CheckpointRestart;
 EXTERN int WriteGhostZones;
 EXTERN int ReadGhostZones;
+
+/* Output compression: chunked datasets (OutputChunkSize cells per
+   dimension) with shuffle and deflate filters, and optional lossy
+   compression of the fields named in OutputLossyFieldName (mantissa
+   truncation to a number of bits, and/or the HDF5 scale-offset filter
+   with a number of decimal digits). */
+
+EXTERN int OutputCompression;
+EXTERN int OutputCompressionLevel;
+EXTERN int OutputCompressionShuffle;
+EXTERN int OutputChunkSize;
+EXTERN char *OutputLossyFieldName[MAX_NUMBER_OF_BARYON_FIELDS];
+EXTERN int OutputLossyMantissaBits[MAX_NUMBER_OF_BARYON_FIELDS];
+EXTERN int OutputLossyScaleOffsetDigits[MAX_NUMBER_OF_BARYON_FIELDS];
+
+/* Asynchronous output: each processor builds its .cpu file in memory
+   and a background thread writes it to disk while the run continues,
+   unless the file would exceed AsyncOutputStagingMemory (in MB). */
+
+EXTERN int AsyncOutput;
+EXTERN float AsyncOutputStagingMemory;
+
+/* Output aggregation: groups of OutputAggregationSize processors send
+   their grids to the first processor of the group, which writes them
+   all to its .cpu file, with objects aligned to
+   OutputAggregationAlignment bytes. */
+
+EXTERN int OutputAggregationSize;
+EXTERN int OutputAggregationAlignment;
 EXTERN int ProblemType;
 #ifdef NEW_PROBLEM_TYPES
 EXTERN char *ProblemTypeName;
@@ -315,6 +355,26 @@ EXTERN int CopyGravPotential;
 
 EXTERN int PotentialIterations;
 
+/* Composite level solver for the subgrid potential: instead of
+   PotentialIterations full solves, alternate CompositePotentialCycles
+   V-cycles on every grid with the exchange of boundary values, until
+   the residual over the whole level drops below
+   CompositePotentialTolerance (or after CompositePotentialMaxCycles). */
+
+EXTERN int CompositePotentialSolver;
+EXTERN float CompositePotentialTolerance;
+EXTERN int CompositePotentialMaxCycles;
+EXTERN int CompositePotentialCycles;
+
+/* Warm start for the subgrid potential: start each solve from the
+   parent's potential plus the correction to it extrapolated from the
+   last two solutions of the grid (kept across RebuildHierarchy).
+   PotentialSolverTolerance is the relative residual the multigrid
+   solver converges to on a 3D grid. */
+
+EXTERN int PotentialWarmStart;
+EXTERN float PotentialSolverTolerance;
+
 /* Flag indicating whether or not to use the baryon self-gravity approximation
    (subgrid cells influence are approximated by their projection to the
    current grid). */
@@ -343,6 +403,11 @@ EXTERN int WritePotential;
 
 EXTERN int ParticleSubgridDepositMode;
 
+/* Keep the particles of each grid in the Morton order of their cells
+   (see grid::SortParticlesByCell), for a cache friendly deposit. */
+
+EXTERN int ParticleSortByCell;
+
 /* Dual energy formalism (TRUE or FALSE). */
 
 EXTERN int DualEnergyFormalism;
@@ -435,6 +500,11 @@ EXTERN RateDataType RateData;
 EXTERN int H2FormationOnDust;
 EXTERN int MixSpeciesAndColors;
 
+/* Solve the rate equations of the cells of a grid that have not finished
+   their subcycles in compacted batches, instead of row by row. */
+
+EXTERN int MultiSpeciesActiveSetSolver;
+
 /* Glover chemistry/cooling network flags */
 EXTERN int GloverChemistryModel;  // 0 is off, on is 1-7, excluding 6
 
@@ -606,6 +676,11 @@ EXTERN int StaticPartitionNestedGrids;
 EXTERN int ExtractFieldsOnly;
 EXTERN int First_Pass;
 EXTERN int UnigridTranspose;
+
+/* Root grid FFT: pencil decomposition with real-to-complex transforms
+   (CommunicationPencilFFT) rather than slabs. */
+
+EXTERN int PencilFFT;
 EXTERN int NumberOfRootGridTilesPerDimensionPerProcessor;
 EXTERN int CosmologySimulationNumberOfInitialGrids;
 EXTERN int UserDefinedRootGridLayout[3];
@@ -638,6 +713,8 @@ EXTERN int HaloFinderRunAfterOutput;
 EXTERN float HaloFinderLinkingLength;
 EXTERN float HaloFinderTimestep;
 EXTERN FLOAT HaloFinderLastTime;
+EXTERN int HaloFinderMethod;
+EXTERN int HaloFinderBackground;
 
 /* Parameters to turn on floors and ceilings on baryon fields */
 EXTERN int ApplyBoundsToBaryonFields;
@@ -903,6 +980,12 @@ EXTERN int NEQ_MHD;
 EXTERN int ReconstructionMethod;
 EXTERN int PositiveReconstruction;
 EXTERN int RiemannSolverFallback;
+
+/* PPM: sweep slabs of several planes per call to the Fortran kernels
+   (PPMSlabSweep), each holding about PPMSlabSweepCells cells. */
+
+EXTERN int PPMSlabSweep;
+EXTERN int PPMSlabSweepCells;
 EXTERN int RiemannSolver;
 EXTERN int ConservativeReconstruction;
 EXTERN int EOSType;
@@ -1237,6 +1320,11 @@ EXTERN float SmartStarSMSLifetime;
 
 /* For EnzoTiming Behavior */
 EXTERN int TimingCycleSkip; // Frequency of timing data dumps.
+EXTERN int TimingJSONOutput; // 0 = off, 1 = performance.jsonl, 2 = with ranks
+EXTERN int EventTraceStartCycle; // first cycle of the event trace (<0 = off)
+EXTERN int EventTraceStopCycle;  // last cycle of the event trace (<0 = end)
+EXTERN int EventTraceBufferSize; // events kept per thread
+EXTERN int MemoryReport;    // 0 = off, 1 = memory.out, 2 = with imbalance
 
 /* For the galaxy simulation boundary method */
 EXTERN int GalaxySimulationRPSWind;
@@ -418,6 +418,7 @@ typedef long long int   HDF5_hid_t;
 //If MAX_EXTRA_OUTPUTS neesd to be changed, change statements in ReadParameterFile and WriteParameterFile.
 #define MAX_EXTRA_OUTPUTS                10 
 
+#define POTENTIAL_HISTORY_FIELD          -14
 #define BARYONS_ELECTRIC                 -13
 #define BARYONS_MAGNETIC                 -12
 #define JUST_BARYONS                     -11
@@ -490,6 +491,10 @@ typedef long long int   HDF5_hid_t;
 #define MPI_SENDPART_TAG 23
 #define MPI_SENDMARKER_TAG 24
 #define MPI_SGMARKER_TAG 25
+#define MPI_BOUNDARY_EXCHANGE_TAG 26
+#define MPI_OUTPUT_AGGREGATION_TAG 27
+#define MPI_PHOTONSTREAM_TAG 28
+#define MPI_PHOTONTOKEN_TAG 29
 
 /* The Active Particle tag is this big to ensure that the sends and
    recvs in grid::CommunicationSendActiveParticles match up and that the AP
@@ -0,0 +1,49 @@
+#!/usr/bin/env python
+### merge_traces.py
+### Description:
+
+### Joins the event traces written by each MPI process of Enzo
+### (trace_P0000.json, trace_P0001.json, ...; see EventTraceStartCycle)
+### into one file that can be loaded into chrome://tracing or
+### ui.perfetto.dev, with one row per process:
+
+### $ python merge_traces.py -o trace.json trace_P*.json
+
+import json
+import sys
+
+def merge_traces(filenames, output):
+    """
+    Join the events of several trace files (in the JSON array format) into
+    one.
+
+    Parameters
+    ----------
+    filenames : list of strings
+        The per-process trace files
+    output : string
+        The name of the merged trace file
+    """
+    events = []
+    for filename in filenames:
+        text = open(filename, "r").read().strip()
+        ### A trace cut short (e.g. by a crash) may lack the closing bracket.
+        if not text.endswith("]"):
+            text = text.rstrip(",") + "]"
+        events.extend(json.loads(text))
+    out = open(output, "w")
+    json.dump({"traceEvents": events, "displayTimeUnit": "ms"}, out)
+    out.close()
+    return len(events)
+
+if __name__ == "__main__":
+    from optparse import OptionParser
+    usage = "usage: %prog [-o output] trace_P*.json"
+    parser = OptionParser(usage)
+    parser.add_option("-o", "--output", dest="output", default="trace.json",
+                      help="Name of the merged trace (default: trace.json)")
+    (opts, args) = parser.parse_args()
+    if len(args) == 0:
+        parser.error("no trace files given")
+    n = merge_traces(args, opts.output)
+    print("Wrote %d events from %d files to %s" % (n, len(args), opts.output))
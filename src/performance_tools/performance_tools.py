@@ -1001,6 +1001,57 @@ def to_tuple(a):
     except TypeError:
         return a
         
+def read_jsonl(filename):
+    """
+    Read the JSON lines timing output of Enzo (typically called
+    "performance.jsonl"), which holds one JSON object per written cycle.
+
+    Parameters
+    ----------
+    filename : string
+        The name of the file used as input
+
+    Returns
+    -------
+    out : dictionary
+        A dictionary of recarrays, keyed by timer name (e.g. "Level_02" or
+        "Level_02/Hydro"), with the same records as the "Level X" keys of
+        the perform class plus "Bytes/sec".  Counters are included under
+        "Counter <name>", with the records of the non-level keys.  A timer
+        that does not appear in a cycle is left at zero for that cycle.
+    """
+    import json
+    cycles = []
+    for line in open(filename, "r"):
+        if line.strip():
+            cycles.append(json.loads(line))
+
+    timer_records = [('Cycle', 'float'), ('Mean Time', 'float'),
+                     ('Stddev Time', 'float'), ('Min Time', 'float'),
+                     ('Max Time', 'float'), ('Cell Updates', 'float'),
+                     ('Num Grids', 'float'),
+                     ('Updates/processor/sec', 'float'),
+                     ('Bytes/sec', 'float')]
+    counter_records = timer_records[:5]
+    columns = ['mean', 'stddev', 'min', 'max', 'cells', 'grids',
+               'cells_per_sec', 'bytes_per_sec']
+
+    data = {}
+    for i, cycle in enumerate(cycles):
+        for group, prefix, records in [('timers', '', timer_records),
+                                       ('counters', 'Counter ',
+                                        counter_records)]:
+            table = cycle[group]
+            for j, name in enumerate(table['name']):
+                key = prefix + name
+                if key not in data:
+                    data[key] = np.zeros(len(cycles), dtype=records)
+                values = [table[c][j] for c in columns[:len(records)-1]]
+                data[key][i] = tuple([cycle['cycle']] + values)
+    for key in data:
+        data[key]['Cycle'] = [cycle['cycle'] for cycle in cycles]
+    return data
+
 ### *** DEFAULT COMMAND LINE BEHAVIOR ***
 
 ### If performance_tools.py is invoked from the command line, these are its 